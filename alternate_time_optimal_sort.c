@@ -2,11 +2,24 @@
 #include <stdlib.h>
 #include <time.h>
 #include <math.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <unistd.h>
 #include <pthread.h>
 
+#include "line_network.h"
+
+// Temporal blocking default: rounds applied to a tile while it stays in cache
+#define BLOCK_ROUNDS 64
+
+// Skip the per-block sortedness checks and verify once after all n-1 rounds
+static bool verifyOnce = false;
+
 // Structure to represent a processor in the line network
 typedef struct {
     int value;              // Value stored in the processor
+    int origin;             // Position of the value before sorting
     int index;              // Position in the line
     int* sendBuffer;        // Buffer for sending values
     int* recvBuffer;        // Buffer for receiving values
@@ -24,27 +37,67 @@ typedef struct {
     int center;             // Center position for comparison
 } ThreadArgs;
 
-// Initialize the network with random values
+// Structure for hybrid segment worker arguments
+typedef struct {
+    SortKey* keys;          // Flattened packed keys of the network
+    SortKey* scratch;       // Scratch space, same size as keys
+    int* bounds;            // Segment s covers [bounds[s], bounds[s + 1])
+    int segmentCount;       // Number of segments
+    int round;              // Merge round, which fixes the centers that take part
+    int workerId;           // Index of this worker
+    int workerCount;        // Total number of workers
+} SegmentArgs;
+
+// Initialize the network with generated values
 void initNetwork(Network* network, int size) {
     network->size = size;
     network->processors = (Processor*)malloc(size * sizeof(Processor));
 
-    // Seed the random number generator
-    srand(time(NULL));
+    // Generate all keys up front, in parallel and reproducibly from the seed
+    int* keys = (int*)malloc(size * sizeof(int));
+    generateKeys(keys, size);
 
     // Initialize each processor
     for (int i = 0; i < size; i++) {
-        network->processors[i].value = rand() % 1000;  // Random value between 0 and 999
+        network->processors[i].value = keys[i];
+        network->processors[i].origin = i;
         network->processors[i].index = i;
         network->processors[i].sendBuffer = (int*)malloc(sizeof(int));
         network->processors[i].recvBuffer = (int*)malloc(sizeof(int));
     }
+
+    free(keys);
+}
+
+// Check whether processor a must be placed after processor b
+static bool processorGreater(Processor* a, Processor* b) {
+    if (stableMode) {
+        return packKey(a->value, a->origin) > packKey(b->value, b->origin);
+    }
+    return a->value > b->value;
+}
+
+// Compare and swap the values (and their origins) of two processors if needed
+static void compareAndSwapProcessors(Processor* a, Processor* b) {
+    if (processorGreater(a, b)) {
+        int temp = a->value;
+        a->value = b->value;
+        b->value = temp;
+
+        temp = a->origin;
+        a->origin = b->origin;
+        b->origin = temp;
+    }
 }
 
 // Print the values in the network
 void printNetwork(Network* network) {
     printf("Network values: ");
     for (int i = 0; i < network->size; i++) {
+        if (i == PRINT_LIMIT) {
+            printf("...");
+            break;
+        }
         printf("%d ", network->processors[i].value);
     }
     printf("\n");
@@ -53,13 +106,50 @@ void printNetwork(Network* network) {
 // Check if the network is sorted
 int isSorted(Network* network) {
     for (int i = 1; i < network->size; i++) {
-        if (network->processors[i-1].value > network->processors[i].value) {
+        if (processorGreater(&network->processors[i-1], &network->processors[i])) {
             return 0;  // Not sorted
         }
     }
     return 1;  // Sorted
 }
 
+// Flatten the network into packed keys (origins only count in stable mode)
+SortKey* flattenNetwork(Network* network) {
+    SortKey* keys = (SortKey*)malloc(network->size * sizeof(SortKey));
+    for (int i = 0; i < network->size; i++) {
+        Processor* processor = &network->processors[i];
+        keys[i] = packKey(processor->value, stableMode ? processor->origin : 0);
+    }
+    return keys;
+}
+
+// Key of a processor as verified (origins only count in stable mode)
+static SortKey processorKey(const Processor* processor) {
+    return packKey(processor->value, stableMode ? processor->origin : 0);
+}
+
+// Thread function to verify one chunk of processors in place, without flattening
+void* verifyProcessorChunk(void* arg) {
+    VerifyArgs* args = (VerifyArgs*)arg;
+    const Processor* processors = (const Processor*)args->source;
+    int last = (args->to < args->size) ? args->to : args->size - 1;
+
+    for (int i = args->from; i < args->to; i++) {
+        SortKey key = processorKey(&processors[i]);
+        if (i < last && key > processorKey(&processors[i + 1])) {
+            args->result.sorted = false;
+        }
+        addToChecksum(&args->result, key);
+    }
+
+    return NULL;
+}
+
+// Verify the network in parallel, each worker reading its processors directly
+Verification verifyNetwork(Network* network) {
+    return verifyParallel(verifyProcessorChunk, network->processors, network->size);
+}
+
 // Clean up the network resources
 void cleanupNetwork(Network* network) {
     for (int i = 0; i < network->size; i++) {
@@ -69,16 +159,6 @@ void cleanupNetwork(Network* network) {
     free(network->processors);
 }
 
-// Utility function to find the minimum of two values
-int minimum(int a, int b) {
-    return (a < b) ? a : b;
-}
-
-// Utility function to find the maximum of two values
-int maximum(int a, int b) {
-    return (a > b) ? a : b;
-}
-
 // Thread function for comparison operations
 void* compare(void* arg) {
     ThreadArgs* args = (ThreadArgs*)arg;
@@ -86,39 +166,22 @@ void* compare(void* arg) {
     int center = args->center;
     int n = network->size;
 
+    Processor* processors = network->processors;
+
     // Edge case: left boundary
     if (center == 0) {
-        if (network->processors[center].value > network->processors[center + 1].value) {
-            // Swap values
-            int temp = network->processors[center].value;
-            network->processors[center].value = network->processors[center + 1].value;
-            network->processors[center + 1].value = temp;
-        }
+        compareAndSwapProcessors(&processors[center], &processors[center + 1]);
     }
     // Edge case: right boundary
     else if (center == n - 1) {
-        if (network->processors[center].value < network->processors[center - 1].value) {
-            // Swap values
-            int temp = network->processors[center].value;
-            network->processors[center].value = network->processors[center - 1].value;
-            network->processors[center - 1].value = temp;
-        }
+        compareAndSwapProcessors(&processors[center - 1], &processors[center]);
     }
-    // Non-edge case: sort 3 elements (center and its neighbors)
+    // Non-edge case: sort 3 elements (center and its neighbors) with a 3-comparator
+    // network, which keeps each value's origin and cannot overflow
     else if (center > 0 && center < n - 1) {
-        int leftVal = network->processors[center - 1].value;
-        int centerVal = network->processors[center].value;
-        int rightVal = network->processors[center + 1].value;
-
-        // Find min, max, and middle values
-        int minValue = minimum(centerVal, minimum(leftVal, rightVal));
-        int maxValue = maximum(centerVal, maximum(leftVal, rightVal));
-        int midValue = leftVal + centerVal + rightVal - minValue - maxValue;
-
-        // Place the values in correct positions
-        network->processors[center - 1].value = minValue;
-        network->processors[center].value = midValue;
-        network->processors[center + 1].value = maxValue;
+        compareAndSwapProcessors(&processors[center - 1], &processors[center]);
+        compareAndSwapProcessors(&processors[center], &processors[center + 1]);
+        compareAndSwapProcessors(&processors[center - 1], &processors[center]);
     }
 
     return NULL;
@@ -176,15 +239,453 @@ void alternativeTimeOptimalSort(Network* network) {
     free(args);
 }
 
+// Compare and swap positions i and i + 1 of the flattened keys in either mode
+static void compareAndSwapAt(void* keys, int i) {
+    if (stableMode) {
+        compareAndSwapPacked((SortKey*)keys, i);
+    } else {
+        compareAndSwapKeys((int*)keys, i);
+    }
+}
+
+// Apply the centers of the given round that lie in [from, to]; a center sorts
+// itself and its neighbours, or a single pair at either end of the line
+static void applyRound(void* keys, int n, int round, int from, int to) {
+    int startPos = round % 3;
+    if (from < 0) {
+        from = 0;
+    }
+    if (to > n - 1) {
+        to = n - 1;
+    }
+    int center = from + ((startPos - from % 3) + 3) % 3;
+
+    for (; center <= to; center += 3) {
+        if (center == 0) {
+            compareAndSwapAt(keys, 0);
+        } else if (center == n - 1) {
+            compareAndSwapAt(keys, n - 2);
+        } else {
+            // 3-element sorting network, as in compare()
+            compareAndSwapAt(keys, center - 1);
+            compareAndSwapAt(keys, center);
+            compareAndSwapAt(keys, center - 1);
+        }
+    }
+}
+
+// Upright trapezoids: a center spans 3 keys, so round t of a block keeps 2t keys
+// away from each interior tile edge and every tile can advance independently
+void* trapezoidThread(void* arg) {
+    TileArgs* args = (TileArgs*)arg;
+    int n = args->size;
+
+    for (int tile = args->workerId; tile < args->tileCount; tile += args->workerCount) {
+        int lo = tile * args->tileWidth;
+        int hi = (lo + args->tileWidth < n) ? lo + args->tileWidth : n;
+
+        for (int t = 0; t < args->steps; t++) {
+            int from = (lo == 0) ? 0 : lo + 2 * t + 1;
+            int to = (hi == n) ? n - 1 : hi - 2 - 2 * t;
+            applyRound(args->keys, n, args->firstStep + t, from, to);
+        }
+    }
+
+    return NULL;
+}
+
+// Inverted trapezoids: fill in the halo centers around each interior tile edge
+// that the upright trapezoids on either side left out
+void* valleyThread(void* arg) {
+    TileArgs* args = (TileArgs*)arg;
+    int n = args->size;
+
+    for (int tile = args->workerId + 1; tile < args->tileCount; tile += args->workerCount) {
+        int edge = tile * args->tileWidth;
+
+        for (int t = 0; t < args->steps; t++) {
+            applyRound(args->keys, n, args->firstStep + t, edge - 1 - 2 * t, edge + 2 * t);
+        }
+    }
+
+    return NULL;
+}
+
+// Alternative Time-Optimal Sort with temporal blocking: the values are flattened
+// into an array and BLOCK_ROUNDS rounds are applied to each cache-resident tile
+// before it is evicted, cutting memory traffic from O(n^2) to roughly O(n^2 / rounds)
+void alternativeTimeOptimalSortBlocked(Network* network, int blockRounds) {
+    int n = network->size;
+    printf("Starting Alternative Time-Optimal Sort (Temporal Blocking)...\n");
+
+    // Stable mode sorts packed (value, origin) words instead of plain values
+    void* keys = malloc(n * (stableMode ? sizeof(SortKey) : sizeof(int)));
+    for (int i = 0; i < n; i++) {
+        Processor* processor = &network->processors[i];
+        if (stableMode) {
+            ((SortKey*)keys)[i] = packKey(processor->value, processor->origin);
+        } else {
+            ((int*)keys)[i] = processor->value;
+        }
+    }
+
+    // Halo regions of neighbouring edges must not overlap
+    int tileWidth = TILE_WIDTH;
+    if (blockRounds > tileWidth / 4) {
+        blockRounds = tileWidth / 4;
+    }
+    if (blockRounds < 1) {
+        blockRounds = 1;
+    }
+
+    int tileCount = (n + tileWidth - 1) / tileWidth;
+    int workerCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (workerCount > tileCount) {
+        workerCount = tileCount;
+    }
+    if (workerCount < 1) {
+        workerCount = 1;
+    }
+
+    pthread_t* threads = (pthread_t*)malloc(workerCount * sizeof(pthread_t));
+    TileArgs* args = (TileArgs*)malloc(workerCount * sizeof(TileArgs));
+
+    // For n-1 rounds, in blocks of blockRounds
+    for (int round = 1; round < n; round += blockRounds) {
+        int rounds = (round + blockRounds <= n) ? blockRounds : n - round;
+
+        for (int i = 0; i < workerCount; i++) {
+            args[i].keys = keys;
+            args[i].size = n;
+            args[i].tileWidth = tileWidth;
+            args[i].tileCount = tileCount;
+            args[i].firstStep = round;
+            args[i].steps = rounds;
+            args[i].workerId = i;
+            args[i].workerCount = workerCount;
+        }
+
+        runTileStage(trapezoidThread, args, threads, workerCount);
+        runTileStage(valleyThread, args, threads, workerCount);
+
+        // Write the block back whenever the network is printed or checked
+        bool lastBlock = round + rounds >= n;
+        if (!verifyOnce || lastBlock || n <= PRINT_LIMIT) {
+            for (int i = 0; i < n; i++) {
+                Processor* processor = &network->processors[i];
+                if (stableMode) {
+                    SortKey key = ((SortKey*)keys)[i];
+                    processor->value = unpackValue(key);
+                    processor->origin = unpackOrigin(key);
+                } else {
+                    processor->value = ((int*)keys)[i];
+                }
+            }
+        }
+        if (n <= PRINT_LIMIT) {
+            printf("Round %d: ", round + rounds - 1);
+            printNetwork(network);
+        }
+
+        // A sorted line is a fixed point of every later round
+        if (!verifyOnce && isSorted(network)) {
+            break;
+        }
+    }
+
+    printf("Sorting completed.\n");
+
+    free(threads);
+    free(args);
+    free(keys);
+}
+
+// Alternative Time-Optimal Sort under injected faults, simulated serially: a center
+// only works when it is active, and it only exchanges with a neighbour that is
+// active and whose message gets through (with one link missing it sorts the pair
+// it can still reach). Runs the fault-free bound of n-1 rounds, or with
+// selfStabilise until every adjacent pair has been compared since the last swap.
+void alternativeTimeOptimalSortFaulty(Network* network) {
+    int n = network->size;
+    Processor* processors = network->processors;
+    printf("Starting Alternative Time-Optimal Sort (Fault Injection)...\n");
+
+    FaultState state;
+    initFaultState(&state, n);
+
+    int round = 0;
+    int sortedAt = isSorted(network) ? 0 : -1;
+    int lastSwapRound = 0;
+    int totalFaults = 0;
+
+    while (n > 1 && round < FAULT_ROUND_LIMIT * n + STUCK_ROUNDS) {
+        if (!faults.selfStabilise && round >= n - 1) break;
+        round++;
+
+        drawFaults(&state, n, round);
+        int swaps = 0;
+        int skipped = 0;
+
+        for (int center = round % 3; center < n; center += 3) {
+            bool leftLink = center > 0 && state.active[center] && state.active[center - 1] &&
+                            !state.dropped[center - 1];
+            bool rightLink = center < n - 1 && state.active[center] && state.active[center + 1] &&
+                             !state.dropped[center];
+            skipped += (center > 0 && !leftLink) + (center < n - 1 && !rightLink);
+            if (leftLink) {
+                state.checkedAt[center - 1] = round;
+            }
+            if (rightLink) {
+                state.checkedAt[center] = round;
+            }
+
+            if (leftLink && rightLink) {
+                swaps += processorGreater(&processors[center - 1], &processors[center]) ||
+                         processorGreater(&processors[center], &processors[center + 1]);
+                compareAndSwapProcessors(&processors[center - 1], &processors[center]);
+                compareAndSwapProcessors(&processors[center], &processors[center + 1]);
+                compareAndSwapProcessors(&processors[center - 1], &processors[center]);
+            } else if (leftLink) {
+                swaps += processorGreater(&processors[center - 1], &processors[center]);
+                compareAndSwapProcessors(&processors[center - 1], &processors[center]);
+            } else if (rightLink) {
+                swaps += processorGreater(&processors[center], &processors[center + 1]);
+                compareAndSwapProcessors(&processors[center], &processors[center + 1]);
+            }
+        }
+
+        totalFaults += state.faultCount;
+        if (sortedAt < 0 && isSorted(network)) {
+            sortedAt = round;
+        }
+
+        if (n <= PRINT_LIMIT) {
+            printf("Round %d (%d skipped): ", round, skipped);
+            printNetwork(network);
+        }
+
+        if (swaps > 0) {
+            lastSwapRound = round;
+        }
+        if (faults.selfStabilise && quiescent(&state, n - 1, lastSwapRound)) break;
+    }
+
+    reportFaultRun("rounds", round, sortedAt, (n > 1) ? n - 1 : 0, totalFaults);
+
+    cleanupFaultState(&state);
+}
+
+// LSD radix sort of packed keys, one byte per pass; a pass where every key has the
+// same digit is skipped, so unstable keys (origin bits all zero) take 4 passes
+static void radixSortKeys(SortKey* keys, SortKey* scratch, int count) {
+    SortKey* from = keys;
+    SortKey* to = scratch;
+
+    for (int shift = 0; shift < 64; shift += 8) {
+        int offsets[256] = {0};
+        for (int i = 0; i < count; i++) {
+            offsets[(from[i] >> shift) & 0xFF]++;
+        }
+        if (count == 0 || offsets[(from[0] >> shift) & 0xFF] == count) continue;
+
+        int total = 0;
+        for (int digit = 0; digit < 256; digit++) {
+            int bucket = offsets[digit];
+            offsets[digit] = total;
+            total += bucket;
+        }
+        for (int i = 0; i < count; i++) {
+            to[offsets[(from[i] >> shift) & 0xFF]++] = from[i];
+        }
+
+        SortKey* temp = from;
+        from = to;
+        to = temp;
+    }
+
+    if (from != keys) {
+        memcpy(keys, from, count * sizeof(SortKey));
+    }
+}
+
+// Merge the sorted runs [lo, mid) and [mid, hi) in place, using scratch[lo, mid)
+static void mergeRuns(SortKey* keys, SortKey* scratch, int lo, int mid, int hi) {
+    // Runs that are already in order need no exchange
+    if (lo == mid || mid == hi || keys[mid - 1] <= keys[mid]) return;
+
+    memcpy(scratch + lo, keys + lo, (mid - lo) * sizeof(SortKey));
+    int i = lo;
+    int j = mid;
+    int out = lo;
+    while (i < mid && j < hi) {
+        keys[out++] = (keys[j] < scratch[i]) ? keys[j++] : scratch[i++];
+    }
+    while (i < mid) {
+        keys[out++] = scratch[i++];
+    }
+}
+
+// Thread function to sort every workerCount-th segment locally
+void* sortSegments(void* arg) {
+    SegmentArgs* args = (SegmentArgs*)arg;
+    for (int s = args->workerId; s < args->segmentCount; s += args->workerCount) {
+        int lo = args->bounds[s];
+        int hi = args->bounds[s + 1];
+        radixSortKeys(args->keys + lo, args->scratch + lo, hi - lo);
+    }
+    return NULL;
+}
+
+// Thread function for the block exchanges of a round: each center segment handed
+// to this worker merges with its neighbours (or with its one neighbour at either
+// end of the line), which is the 3-center compare operation on whole sorted blocks
+void* mergeCenters(void* arg) {
+    SegmentArgs* args = (SegmentArgs*)arg;
+    int* bounds = args->bounds;
+
+    // Centers 3 apart touch disjoint ranges of segments
+    for (int center = args->round % 3 + 3 * args->workerId; center < args->segmentCount;
+         center += 3 * args->workerCount) {
+        int first = (center > 0) ? center - 1 : center;
+        int last = (center < args->segmentCount - 1) ? center + 1 : center;
+
+        for (int s = first + 1; s <= last; s++) {
+            mergeRuns(args->keys, args->scratch, bounds[first], bounds[s], bounds[s + 1]);
+        }
+    }
+
+    return NULL;
+}
+
+// Check whether every segment boundary is in order, i.e. the line is sorted
+static bool boundariesOrdered(SortKey* keys, int* bounds, int segmentCount) {
+    for (int s = 1; s < segmentCount; s++) {
+        int edge = bounds[s];
+        if (edge > 0 && edge < bounds[segmentCount] && keys[edge - 1] > keys[edge]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Hybrid Alternative Time-Optimal Sort: the line is cut into segments, each is
+// radix sorted locally on its own thread, and the boundaries are then fixed up by
+// running the alternative algorithm on the P segment processors with whole-block
+// 3-center exchanges until every boundary is ordered. With equal segments this
+// takes at most P-1 rounds, since merging sorted blocks behaves like a comparator
+// on them; segments that differ by one key can need a few more, but every merge
+// that changes anything removes inversions, so the rounds always terminate.
+void alternativeTimeOptimalSortHybrid(Network* network, int segmentCount) {
+    int n = network->size;
+    printf("Starting Alternative Time-Optimal Sort (Hybrid, %d segments)...\n", segmentCount);
+
+    if (segmentCount > n) {
+        segmentCount = n;
+    }
+    if (segmentCount < 1) {
+        segmentCount = 1;
+    }
+
+    SortKey* keys = flattenNetwork(network);
+    SortKey* scratch = (SortKey*)malloc(n * sizeof(SortKey));
+    int* bounds = (int*)malloc((segmentCount + 1) * sizeof(int));
+    for (int s = 0; s <= segmentCount; s++) {
+        bounds[s] = (int)((int64_t)n * s / segmentCount);
+    }
+
+    // A pool of at most one worker per core takes the segments, and the centers
+    // of each merge round, in turn
+    int workerCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (workerCount > segmentCount) {
+        workerCount = segmentCount;
+    }
+    if (workerCount < 1) {
+        workerCount = 1;
+    }
+
+    pthread_t* threads = (pthread_t*)malloc(workerCount * sizeof(pthread_t));
+    SegmentArgs* args = (SegmentArgs*)malloc(workerCount * sizeof(SegmentArgs));
+    for (int i = 0; i < workerCount; i++) {
+        args[i].keys = keys;
+        args[i].scratch = scratch;
+        args[i].bounds = bounds;
+        args[i].segmentCount = segmentCount;
+        args[i].round = 0;
+        args[i].workerId = i;
+        args[i].workerCount = workerCount;
+    }
+
+    // Local sort inside each segment
+    for (int i = 0; i < workerCount; i++) {
+        pthread_create(&threads[i], NULL, sortSegments, &args[i]);
+    }
+    for (int i = 0; i < workerCount; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    // Line-network merge across segments
+    int round;
+    for (round = 1; !boundariesOrdered(keys, bounds, segmentCount); round++) {
+        for (int i = 0; i < workerCount; i++) {
+            args[i].round = round;
+            pthread_create(&threads[i], NULL, mergeCenters, &args[i]);
+        }
+        for (int i = 0; i < workerCount; i++) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+
+    // Write the keys back to the processors
+    for (int i = 0; i < n; i++) {
+        Processor* processor = &network->processors[i];
+        processor->value = unpackValue(keys[i]);
+        if (stableMode) {
+            processor->origin = unpackOrigin(keys[i]);
+        }
+    }
+
+    if (n <= PRINT_LIMIT) {
+        printNetwork(network);
+    }
+    printf("Sorting completed in %d merge rounds.\n", round - 1);
+
+    free(threads);
+    free(args);
+    free(bounds);
+    free(scratch);
+    free(keys);
+}
+
 // Main function to test Alternative Time-Optimal Sort
 int main(int argc, char* argv[]) {
     int size = 10;  // Default size
-
-    // Check if size is provided as command line argument
-    if (argc > 1) {
-        size = atoi(argv[1]);
+    int blockRounds = 0;  // 0 selects the thread-per-center engine
+    int segmentCount = 0;  // Segments for the hybrid engine, 0 to disable it
+    generator.seed = (uint64_t)time(NULL);  // Overridden by --seed
+
+    // Parse the size and optional flags from the command line
+    for (int i = 1; i < argc; i++) {
+        if (parseGeneratorFlag(argc, argv, &i) || parseFaultFlag(argc, argv, &i)) {
+            continue;
+        } else if (strcmp(argv[i], "--blocked") == 0 && i + 1 < argc && argv[i + 1][0] != '-') {
+            blockRounds = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--blocked") == 0) {
+            blockRounds = BLOCK_ROUNDS;
+        } else if (strcmp(argv[i], "--hybrid") == 0 && i + 1 < argc && argv[i + 1][0] != '-') {
+            segmentCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--hybrid") == 0) {
+            segmentCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        } else if (strcmp(argv[i], "--verify-once") == 0) {
+            verifyOnce = true;
+        } else if (strcmp(argv[i], "--stable") == 0) {
+            stableMode = true;
+        } else {
+            size = atoi(argv[i]);
+        }
     }
 
+    printf("Seed: %llu\n", (unsigned long long)generator.seed);
+
     // Create a network
     Network network;
     initNetwork(&network, size);
@@ -192,22 +693,38 @@ int main(int argc, char* argv[]) {
     // Print the initial state
     printf("Initial state (n=%d):\n", size);
     printNetwork(&network);
+    Verification before = verifyNetwork(&network);
 
     // Execute Alternative Time-Optimal Sort
     clock_t start = clock();
-    alternativeTimeOptimalSort(&network);
+    if (faultModeEnabled()) {
+        alternativeTimeOptimalSortFaulty(&network);
+    } else if (segmentCount > 0) {
+        alternativeTimeOptimalSortHybrid(&network, segmentCount);
+    } else if (blockRounds > 0) {
+        alternativeTimeOptimalSortBlocked(&network, blockRounds);
+    } else {
+        alternativeTimeOptimalSort(&network);
+    }
     clock_t end = clock();
 
-    // Check if sorted correctly
-    if (isSorted(&network)) {
+    // Check if sorted correctly and that no value was lost or duplicated
+    double verifyStart = wallTime();
+    Verification after = verifyNetwork(&network);
+    double verifyTime = wallTime() - verifyStart;
+    if (after.sorted) {
         printf("Network is correctly sorted.\n");
     } else {
         printf("ERROR: Network is not sorted correctly!\n");
     }
+    if (!sameMultiset(&before, &after)) {
+        printf("ERROR: Checksum mismatch, values were lost or duplicated!\n");
+    }
 
     // Print execution time
     double cpu_time_used = ((double) (end - start)) / CLOCKS_PER_SEC;
     printf("Execution time: %f seconds\n", cpu_time_used);
+    printf("Verification time: %f seconds\n", verifyTime);
 
     // Clean up
     cleanupNetwork(&network);
@@ -0,0 +1,457 @@
+#ifndef LINE_NETWORK_H
+#define LINE_NETWORK_H
+
+// Code shared by the three line-network sorts. Each program is a single
+// translation unit, so the definitions live here and "gcc x.c" still builds it.
+// Every definition is static, so a second translation unit including the header
+// gets its own copy instead of a duplicate symbol.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+// Key generator: distinct keys in the few-unique distribution, and the smallest
+// chunk worth handing to a separate thread
+#define FEW_UNIQUE_KEYS 16
+#define GENERATOR_CHUNK 65536
+
+// Input distributions produced by the key generator
+typedef enum {
+    DIST_UNIFORM,               // Independent keys spread over the range
+    DIST_FEW_UNIQUE,            // Only FEW_UNIQUE_KEYS distinct keys
+    DIST_SORTED,                // Already sorted ascending
+    DIST_REVERSED               // Sorted descending
+} Distribution;
+
+// Structure to configure the deterministic key generator
+typedef struct {
+    uint64_t seed;              // Same seed, range and distribution give the same keys
+    int minKey;                 // Smallest key produced
+    int maxKey;                 // Largest key produced
+    Distribution distribution;  // Shape of the input
+} GeneratorConfig;
+
+// Structure to hold arguments for a generator worker
+typedef struct {
+    int* keys;                  // Output array
+    int size;                   // Total number of keys
+    int from;                   // First position filled by this worker
+    int to;                     // One past the last position filled by this worker
+} GeneratorArgs;
+
+// Keys 0..999 match the historical rand() % 1000 inputs
+static GeneratorConfig generator = {0, 0, 999, DIST_UNIFORM};
+
+// splitmix64 finalizer: a counter-based generator, so key i depends only on
+// (seed, i) and chunks can be filled in any order on any number of threads
+static inline uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Produce the key at a position for the configured range and distribution
+static inline int generateKey(int position, int size) {
+    uint64_t range = (uint64_t)((int64_t)generator.maxKey - generator.minKey) + 1;
+    uint64_t random = splitmix64(generator.seed + (uint64_t)position * 0x9E3779B97F4A7C15ull);
+    uint64_t offset;
+
+    switch (generator.distribution) {
+        case DIST_FEW_UNIQUE: {
+            // Spread the distinct keys evenly, and use every value of a narrow range
+            uint64_t distinct = (range < FEW_UNIQUE_KEYS) ? range : FEW_UNIQUE_KEYS;
+            offset = range * (random % distinct) / distinct;
+            break;
+        }
+        case DIST_SORTED:
+            offset = (uint64_t)position * range / (uint64_t)size;
+            break;
+        case DIST_REVERSED:
+            offset = (uint64_t)(size - 1 - position) * range / (uint64_t)size;
+            break;
+        default:
+            // Multiply-shift maps the high 32 bits onto the range without modulo bias
+            offset = ((random >> 32) * range) >> 32;
+            break;
+    }
+
+    return (int)((int64_t)generator.minKey + (int64_t)offset);
+}
+
+// Thread function to fill one contiguous chunk of keys
+static inline void* generateChunk(void* arg) {
+    GeneratorArgs* args = (GeneratorArgs*)arg;
+    for (int i = args->from; i < args->to; i++) {
+        args->keys[i] = generateKey(i, args->size);
+    }
+    return NULL;
+}
+
+// Fill keys[0..size) in parallel; the result does not depend on the thread count
+static inline void generateKeys(int* keys, int size) {
+    int workerCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (workerCount > size / GENERATOR_CHUNK) {
+        workerCount = size / GENERATOR_CHUNK;
+    }
+    if (workerCount < 1) {
+        workerCount = 1;
+    }
+
+    pthread_t* threads = (pthread_t*)malloc(workerCount * sizeof(pthread_t));
+    GeneratorArgs* args = (GeneratorArgs*)malloc(workerCount * sizeof(GeneratorArgs));
+    int chunk = (size + workerCount - 1) / workerCount;
+
+    for (int i = 0; i < workerCount; i++) {
+        args[i].keys = keys;
+        args[i].size = size;
+        args[i].from = (i * chunk < size) ? i * chunk : size;
+        args[i].to = (args[i].from + chunk < size) ? args[i].from + chunk : size;
+        pthread_create(&threads[i], NULL, generateChunk, &args[i]);
+    }
+    for (int i = 0; i < workerCount; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    free(threads);
+    free(args);
+}
+
+// Consume a generator flag (--seed S, --range MIN:MAX, --dist NAME) at argv[*i]
+static inline bool parseGeneratorFlag(int argc, char* argv[], int* i) {
+    if (*i + 1 >= argc) return false;
+
+    if (strcmp(argv[*i], "--seed") == 0) {
+        generator.seed = strtoull(argv[++(*i)], NULL, 10);
+        return true;
+    }
+    if (strcmp(argv[*i], "--range") == 0) {
+        const char* text = argv[++(*i)];
+        if (sscanf(text, "%d:%d", &generator.minKey, &generator.maxKey) != 2 ||
+            generator.maxKey < generator.minKey) {
+            printf("ERROR: --range expects MIN:MAX with MIN <= MAX, got '%s'\n", text);
+            exit(1);
+        }
+        return true;
+    }
+    if (strcmp(argv[*i], "--dist") == 0) {
+        const char* name = argv[++(*i)];
+        if (strcmp(name, "few") == 0) {
+            generator.distribution = DIST_FEW_UNIQUE;
+        } else if (strcmp(name, "sorted") == 0) {
+            generator.distribution = DIST_SORTED;
+        } else if (strcmp(name, "reversed") == 0) {
+            generator.distribution = DIST_REVERSED;
+        } else if (strcmp(name, "uniform") == 0) {
+            generator.distribution = DIST_UNIFORM;
+        } else {
+            printf("ERROR: --dist expects uniform, few, sorted or reversed, got '%s'\n", name);
+            exit(1);
+        }
+        return true;
+    }
+    return false;
+}
+
+// Smallest chunk of keys worth verifying on a separate thread
+#define VERIFY_CHUNK 65536
+
+// A key and its origin packed into one 64-bit word, so that stable mode breaks
+// ties by origin while a compare stays a single integer op
+typedef uint64_t SortKey;
+static bool stableMode = false;
+
+// Sign bias that makes the unsigned order of the high half match signed values
+#define SORT_KEY_BIAS 0x80000000u
+
+// Pack a value and its origin so that unsigned order matches (value, origin) order
+static inline SortKey packKey(int value, int origin) {
+    return ((SortKey)((uint32_t)value ^ SORT_KEY_BIAS) << 32) | (uint32_t)origin;
+}
+
+// Recover the value packed into a key
+static inline int unpackValue(SortKey key) {
+    return (int)((uint32_t)(key >> 32) ^ SORT_KEY_BIAS);
+}
+
+// Recover the origin packed into a key
+static inline int unpackOrigin(SortKey key) {
+    return (int)(uint32_t)key;
+}
+
+// Structure to hold the result of verifying a network
+typedef struct {
+    bool sorted;                // Keys are in non-decreasing order
+    uint64_t count;             // Number of keys
+    uint64_t sum;               // Sum of key hashes (order-independent)
+    uint64_t xorHash;           // XOR of key hashes (order-independent)
+} Verification;
+
+// Structure to hold arguments for a verification worker
+typedef struct {
+    const void* source;         // Flattened keys, or the network's own storage
+    int size;                   // Total number of entries in the source
+    int from;                   // First entry checked by this worker
+    int to;                     // One past the last entry checked by this worker
+    Verification result;        // Partial result for this chunk
+} VerifyArgs;
+
+// Fold a key into the multiset checksum. Only the value is hashed, so the
+// checksum ignores where a key ended up
+static inline void addToChecksum(Verification* result, SortKey key) {
+    uint64_t hash = splitmix64(key >> 32);
+    result->count++;
+    result->sum += hash;
+    result->xorHash ^= hash;
+}
+
+// Thread function to check the order of one chunk of flattened keys (including
+// the pair that crosses into the next chunk) and fold them into the checksum
+static inline void* verifyChunk(void* arg) {
+    VerifyArgs* args = (VerifyArgs*)arg;
+    const SortKey* keys = (const SortKey*)args->source;
+    int last = (args->to < args->size) ? args->to : args->size - 1;
+
+    for (int i = args->from; i < last; i++) {
+        if (keys[i] > keys[i + 1]) {
+            args->result.sorted = false;
+            break;
+        }
+    }
+    for (int i = args->from; i < args->to; i++) {
+        addToChecksum(&args->result, keys[i]);
+    }
+
+    return NULL;
+}
+
+// Run a verification worker over chunks of source[0..size) in parallel and
+// combine the partial results: sortedness plus a multiset checksum that catches
+// lost or duplicated keys when compared with the checksum of the input
+static inline Verification verifyParallel(void* (*worker)(void*), const void* source, int size) {
+    int workerCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (workerCount > size / VERIFY_CHUNK) {
+        workerCount = size / VERIFY_CHUNK;
+    }
+    if (workerCount < 1) {
+        workerCount = 1;
+    }
+
+    pthread_t* threads = (pthread_t*)malloc(workerCount * sizeof(pthread_t));
+    VerifyArgs* args = (VerifyArgs*)malloc(workerCount * sizeof(VerifyArgs));
+    int chunk = (size + workerCount - 1) / workerCount;
+
+    for (int i = 0; i < workerCount; i++) {
+        args[i].source = source;
+        args[i].size = size;
+        args[i].from = (i * chunk < size) ? i * chunk : size;
+        args[i].to = (args[i].from + chunk < size) ? args[i].from + chunk : size;
+        args[i].result = (Verification){true, 0, 0, 0};
+        pthread_create(&threads[i], NULL, worker, &args[i]);
+    }
+
+    Verification total = {true, 0, 0, 0};
+    for (int i = 0; i < workerCount; i++) {
+        pthread_join(threads[i], NULL);
+        total.sorted = total.sorted && args[i].result.sorted;
+        total.count += args[i].result.count;
+        total.sum += args[i].result.sum;
+        total.xorHash ^= args[i].result.xorHash;
+    }
+
+    free(threads);
+    free(args);
+    return total;
+}
+
+// Verify flattened keys in parallel
+static inline Verification verifyKeys(SortKey* keys, int size) {
+    return verifyParallel(verifyChunk, keys, size);
+}
+
+// Wall-clock time in seconds, for timing the sorts and their verification
+// (clock() would add up the CPU time of all workers)
+static inline double wallTime(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// Check whether two verifications saw the same multiset of keys
+static inline bool sameMultiset(Verification* a, Verification* b) {
+    return a->count == b->count && a->sum == b->sum && a->xorHash == b->xorHash;
+}
+
+// Networks larger than this are printed in abbreviated form
+#define PRINT_LIMIT 64
+
+// Temporal blocking: a tile of TILE_WIDTH keys (16 KB of int keys, 32 KB of
+// SortKeys in stable mode) stays in L1/L2 while a block of steps is applied to it
+#define TILE_WIDTH 4096
+
+// Structure to hold arguments for a temporally blocked tile worker
+typedef struct {
+    void* keys;                 // Flattened values (SortKey in stable mode, else int)
+    int size;                   // Number of keys
+    int tileWidth;              // Keys per tile
+    int tileCount;              // Number of tiles
+    int firstStep;              // Global number of the first phase or round in the block
+    int steps;                  // Phases or rounds applied per block
+    int workerId;               // Index of this worker
+    int workerCount;            // Total number of workers
+} TileArgs;
+
+// Compare and swap the flattened keys at positions i and i + 1
+static inline void compareAndSwapKeys(int* keys, int i) {
+    if (keys[i] > keys[i + 1]) {
+        int temp = keys[i];
+        keys[i] = keys[i + 1];
+        keys[i + 1] = temp;
+    }
+}
+
+// Compare and swap the packed stable keys at positions i and i + 1
+static inline void compareAndSwapPacked(SortKey* keys, int i) {
+    if (keys[i] > keys[i + 1]) {
+        SortKey temp = keys[i];
+        keys[i] = keys[i + 1];
+        keys[i + 1] = temp;
+    }
+}
+
+// Run one stage (trapezoids or valleys) of a block across the worker threads
+static inline void runTileStage(void* (*stage)(void*), TileArgs* args, pthread_t* threads, int workerCount) {
+    for (int i = 0; i < workerCount; i++) {
+        pthread_create(&threads[i], NULL, stage, &args[i]);
+    }
+    for (int i = 0; i < workerCount; i++) {
+        pthread_join(threads[i], NULL);
+    }
+}
+
+// Fault injection: rounds a stuck processor stalls for, and the cap on rounds
+// (as a multiple of n) before a faulty run gives up
+#define STUCK_ROUNDS 8
+#define FAULT_ROUND_LIMIT 8
+
+// Kinds of fault drawn independently for every round and processor
+typedef enum {
+    FAULT_DROP,                 // The message on a processor's right link is lost
+    FAULT_DELAY,                // The processor sits out the round
+    FAULT_STUCK                 // The processor stalls for STUCK_ROUNDS rounds
+} FaultKind;
+
+// Structure to configure fault injection
+typedef struct {
+    double dropRate;            // Probability that a compare-exchange message is lost
+    double delayRate;           // Probability that a processor is late for a round
+    double stuckRate;           // Probability that a processor gets stuck
+    bool selfStabilise;         // Run until the line is observed to be quiescent
+} FaultConfig;
+
+// Structure to hold the per-round fault state of the line
+typedef struct {
+    int* stuckUntil;            // Round until which each processor is stuck
+    bool* active;               // Whether each processor takes part in this round
+    bool* dropped;              // Whether each processor's right link loses its message
+    int* checkedAt;             // Last round each comparator ran without being skipped
+    int faultCount;             // Faults injected in this round
+} FaultState;
+
+static FaultConfig faults = {0.0, 0.0, 0.0, false};
+
+// Draw a fault deterministically from (seed, kind, round, processor). Each input
+// goes through its own splitmix64 step, so no two seeds share a fault pattern
+static inline bool faultOccurs(FaultKind kind, double rate, int round, int processor) {
+    if (rate <= 0.0) return false;
+    uint64_t stream = splitmix64(generator.seed + (uint64_t)kind);
+    uint64_t random = splitmix64(stream ^ (splitmix64((uint64_t)round) + (uint64_t)processor));
+    return (random >> 11) * (1.0 / 9007199254740992.0) < rate;
+}
+
+// Draw this round's faults for every processor in the line
+static inline void drawFaults(FaultState* state, int size, int round) {
+    state->faultCount = 0;
+    for (int i = 0; i < size; i++) {
+        if (round >= state->stuckUntil[i] && faultOccurs(FAULT_STUCK, faults.stuckRate, round, i)) {
+            state->stuckUntil[i] = round + STUCK_ROUNDS;
+        }
+        bool late = faultOccurs(FAULT_DELAY, faults.delayRate, round, i);
+        state->active[i] = !late && round >= state->stuckUntil[i];
+        state->dropped[i] = faultOccurs(FAULT_DROP, faults.dropRate, round, i);
+        state->faultCount += !state->active[i] + state->dropped[i];
+    }
+}
+
+// Allocate the fault state for a line of processors and their comparators
+static inline void initFaultState(FaultState* state, int size) {
+    state->stuckUntil = (int*)calloc(size, sizeof(int));
+    state->active = (bool*)malloc(size * sizeof(bool));
+    state->dropped = (bool*)malloc(size * sizeof(bool));
+    state->checkedAt = (int*)calloc(size, sizeof(int));
+}
+
+// Free the fault state
+static inline void cleanupFaultState(FaultState* state) {
+    free(state->stuckUntil);
+    free(state->active);
+    free(state->dropped);
+    free(state->checkedAt);
+}
+
+// Self-stabilisation: rounds without swaps leave the line unchanged, so once every
+// comparator has run since the last round with a swap, all of them saw the same
+// state in order and no further round can change it, however many were skipped
+static inline bool quiescent(FaultState* state, int comparators, int lastSwapRound) {
+    for (int i = 0; i < comparators; i++) {
+        if (state->checkedAt[i] <= lastSwapRound) return false;
+    }
+    return true;
+}
+
+// Check whether fault injection or the self-stabilising continuation is enabled
+static inline bool faultModeEnabled(void) {
+    return faults.dropRate > 0.0 || faults.delayRate > 0.0 || faults.stuckRate > 0.0 ||
+           faults.selfStabilise;
+}
+
+// Consume a fault flag (--drop P, --delay P, --stuck P, --self-stabilise) at argv[*i]
+static inline bool parseFaultFlag(int argc, char* argv[], int* i) {
+    if (strcmp(argv[*i], "--self-stabilise") == 0) {
+        faults.selfStabilise = true;
+        return true;
+    }
+    if (*i + 1 >= argc) return false;
+
+    if (strcmp(argv[*i], "--drop") == 0) {
+        faults.dropRate = atof(argv[++(*i)]);
+        return true;
+    }
+    if (strcmp(argv[*i], "--delay") == 0) {
+        faults.delayRate = atof(argv[++(*i)]);
+        return true;
+    }
+    if (strcmp(argv[*i], "--stuck") == 0) {
+        faults.stuckRate = atof(argv[++(*i)]);
+        return true;
+    }
+    return false;
+}
+
+// Report how many rounds the faulty run needed compared with the fault-free bound
+static inline void reportFaultRun(const char* unit, int rounds, int sortedAt, int bound, int totalFaults) {
+    printf("Injected %d faults over %d %s.\n", totalFaults, rounds, unit);
+    if (sortedAt >= 0) {
+        printf("Sorted after %d %s (%d extra over the fault-free bound of %d).\n",
+               sortedAt, unit, (sortedAt > bound) ? sortedAt - bound : 0, bound);
+    } else {
+        printf("Not sorted after %d %s.\n", rounds, unit);
+    }
+}
+
+#endif // LINE_NETWORK_H
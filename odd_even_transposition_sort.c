@@ -2,27 +2,74 @@
 #include <stdlib.h>
 #include <time.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
 #include <pthread.h>
 
+#include "line_network.h"
+
+// Temporal blocking default: phases applied to a tile while it stays in cache
+#define BLOCK_PHASES 64
+
+// Skip the per-phase sortedness checks and verify once after the fixed n phases
+static bool verifyOnce = false;
+
 // Structure to represent a processor node in the line network
 typedef struct Node {
     int value;                  // Value stored in the processor
-    int index;                  // Position in the line
+    int origin;                 // Position of the value before sorting
+    int index;                  // Phase parity for the re-sort (position when built; may go negative)
     struct Node* left;          // Pointer to left neighbor
     struct Node* right;         // Pointer to right neighbor
+    int window;                 // Re-sort window that compares this node's right pair, or -1
+    int joinedAt;               // Re-sort phase at which that pair joined the window
+    int changedAt;              // Re-sort phase at which the value last changed
+    bool deleted;               // Removed by the batch being applied; freed after it
     pthread_mutex_t lock;       // Lock for thread safety
 } Node;
 
+// Kinds of change accepted by the incremental re-sort
+typedef enum {
+    UPDATE_SET,                 // Replace the value of a processor
+    UPDATE_INSERT,              // Insert a new processor after another
+    UPDATE_DELETE               // Remove a processor
+} UpdateKind;
+
+// Structure to describe one change to a resident sorted network. The handle must be
+// a node of that network; an update naming a node deleted earlier in the same batch
+// is skipped, and handles to deleted nodes dangle once the batch returns
+typedef struct {
+    UpdateKind kind;            // Kind of change
+    Node* node;                 // Processor changed (insert: new one goes after it, NULL for the front)
+    int value;                  // New value (ignored for deletes)
+} Update;
+
+// Structure to hold what a resident network carries from one re-sort to the next;
+// the caller keeps one per network
+typedef struct {
+    int phaseCount;             // Re-sort phases run so far; node stamps refer to it
+    int nextOrigin;             // Origin of the next value set or inserted
+} ResortState;
+
+// Structure to represent a contiguous region of the line being re-sorted
+typedef struct {
+    Node* first;                // Leftmost node whose right pair is compared (NULL once done)
+    Node* last;                 // Rightmost node whose right pair is compared
+} Window;
+
 // Structure to hold arguments for thread function
 typedef struct {
     Node* node;                 // Node to process
+    int position;               // Position of the node, counted by the phase walk
     int phase;                  // Current phase (odd or even)
 } ThreadArgs;
 
-// Initialize the network with random values
+// Initialize the network with generated values
 Node* initNetwork(int size) {
-    // Seed the random number generator
-    srand(time(NULL));
+    // Generate all keys up front, in parallel and reproducibly from the seed
+    int* keys = (int*)malloc(size * sizeof(int));
+    generateKeys(keys, size);
 
     Node* root = NULL;
     Node* prev = NULL;
@@ -32,10 +79,15 @@ Node* initNetwork(int size) {
         Node* node = (Node*)malloc(sizeof(Node));
 
         // Initialize node properties
-        node->value = rand() % 1000;  // Random value between 0 and 999
+        node->value = keys[i];
+        node->origin = i;
         node->index = i;
         node->left = prev;
         node->right = NULL;
+        node->window = -1;
+        node->joinedAt = 0;
+        node->changedAt = 0;
+        node->deleted = false;
         pthread_mutex_init(&node->lock, NULL);
 
         if (prev != NULL) {
@@ -47,6 +99,7 @@ Node* initNetwork(int size) {
         prev = node;
     }
 
+    free(keys);
     return root;
 }
 
@@ -61,9 +114,14 @@ Node* initNetworkWithValues(int arr[], int size) {
 
         // Initialize node properties
         node->value = arr[i];
+        node->origin = i;
         node->index = i;
         node->left = prev;
         node->right = NULL;
+        node->window = -1;
+        node->joinedAt = 0;
+        node->changedAt = 0;
+        node->deleted = false;
         pthread_mutex_init(&node->lock, NULL);
 
         if (prev != NULL) {
@@ -78,13 +136,38 @@ Node* initNetworkWithValues(int arr[], int size) {
     return root;
 }
 
+// Check whether node a must be placed after node b
+static bool nodeGreater(Node* a, Node* b) {
+    if (stableMode) {
+        return packKey(a->value, a->origin) > packKey(b->value, b->origin);
+    }
+    return a->value > b->value;
+}
+
+// Exchange the values (and their origins) held by two nodes
+static void swapNodeValues(Node* a, Node* b) {
+    int temp = a->value;
+    a->value = b->value;
+    b->value = temp;
+
+    temp = a->origin;
+    a->origin = b->origin;
+    b->origin = temp;
+}
+
 // Print the values in the network
 void printNetwork(Node* root) {
     Node* temp = root;
+    int printed = 0;
     printf("Network values: ");
     while (temp != NULL) {
+        if (printed == PRINT_LIMIT) {
+            printf("...");
+            break;
+        }
         printf("%d ", temp->value);
         temp = temp->right;
+        printed++;
     }
     printf("\n");
 }
@@ -95,7 +178,7 @@ int isSorted(Node* root) {
 
     Node* current = root;
     while (current->right != NULL) {
-        if (current->value > current->right->value) {
+        if (nodeGreater(current, current->right)) {
             return 0;  // Not sorted
         }
         current = current->right;
@@ -104,6 +187,25 @@ int isSorted(Node* root) {
     return 1;  // Sorted
 }
 
+// Flatten the network into packed keys (origins only count in stable mode)
+SortKey* flattenNetwork(Node* root, int size) {
+    SortKey* keys = (SortKey*)malloc(size * sizeof(SortKey));
+    Node* current = root;
+    for (int i = 0; i < size; i++) {
+        keys[i] = packKey(current->value, stableMode ? current->origin : 0);
+        current = current->right;
+    }
+    return keys;
+}
+
+// Verify the network in parallel after flattening it
+Verification verifyNetwork(Node* root, int size) {
+    SortKey* keys = flattenNetwork(root, size);
+    Verification result = verifyKeys(keys, size);
+    free(keys);
+    return result;
+}
+
 // Clean up the network resources
 void cleanupNetwork(Node* root) {
     Node* current = root;
@@ -125,10 +227,8 @@ void compareAndSwapNodes(Node* left, Node* right) {
     pthread_mutex_lock(&right->lock);
 
     // Compare and swap if needed
-    if (left->value > right->value) {
-        int temp = left->value;
-        left->value = right->value;
-        right->value = temp;
+    if (nodeGreater(left, right)) {
+        swapNodeValues(left, right);
     }
 
     // Unlock nodes
@@ -142,9 +242,9 @@ void* compareAndSwapThread(void* arg) {
     Node* node = args->node;
     int phase = args->phase;
 
-    // Odd phase: process nodes with odd indices
-    // Even phase: process nodes with even indices
-    if ((node->index % 2 == 1 && phase == 1) || (node->index % 2 == 0 && phase == 0)) {
+    // Odd phase: process nodes at odd positions
+    // Even phase: process nodes at even positions
+    if ((args->position & 1) == phase) {
         // If there's a right neighbor, compare and potentially swap
         if (node->right != NULL) {
             compareAndSwapNodes(node, node->right);
@@ -175,6 +275,7 @@ void oddEvenSort(Node* root, int size) {
             // Create threads for each node
             while (current != NULL) {
                 args[thread_idx].node = current;
+                args[thread_idx].position = thread_idx;
                 args[thread_idx].phase = phase;
 
                 pthread_create(&threads[thread_idx], NULL, compareAndSwapThread, &args[thread_idx]);
@@ -190,13 +291,20 @@ void oddEvenSort(Node* root, int size) {
 
             phase_count++;
 
-            // Check if still sorted after this phase
-            if (!isSorted(root)) {
+            // Check if still sorted after this phase; n phases always suffice,
+            // so with verifyOnce the check is left to the final verification
+            if (verifyOnce ? phase_count < size : !isSorted(root)) {
                 sorted = 0;
             }
 
             printf("After phase %d: ", phase_count);
             printNetwork(root);
+
+            // The fixed n phases may end halfway through an odd/even pair
+            if (verifyOnce && phase_count >= size) {
+                sorted = 1;
+                break;
+            }
         }
 
         // Ensure we don't get stuck in an infinite loop
@@ -212,37 +320,559 @@ void oddEvenSort(Node* root, int size) {
     free(args);
 }
 
+// Apply the pairs (i, i + 1) of the given phase whose left index lies in [from, to]
+static void applyPhase(void* keys, int phase, int from, int to) {
+    // Phase 0 processes even indices, phase 1 odd indices
+    int start = from + ((from & 1) != (phase & 1));
+    if (stableMode) {
+        for (int i = start; i <= to; i += 2) {
+            compareAndSwapPacked((SortKey*)keys, i);
+        }
+    } else {
+        for (int i = start; i <= to; i += 2) {
+            compareAndSwapKeys((int*)keys, i);
+        }
+    }
+}
+
+// Upright trapezoids: phase t of a block only touches pairs at least t keys
+// away from an interior tile edge, so every tile can advance independently
+void* trapezoidThread(void* arg) {
+    TileArgs* args = (TileArgs*)arg;
+    int n = args->size;
+
+    for (int tile = args->workerId; tile < args->tileCount; tile += args->workerCount) {
+        int lo = tile * args->tileWidth;
+        int hi = (lo + args->tileWidth < n) ? lo + args->tileWidth : n;
+
+        for (int t = 0; t < args->steps; t++) {
+            int from = (lo == 0) ? 0 : lo + t;
+            int to = (hi == n) ? n - 2 : hi - 2 - t;
+            applyPhase(args->keys, args->firstStep + t, from, to);
+        }
+    }
+
+    return NULL;
+}
+
+// Inverted trapezoids: fill in the halo pairs around each interior tile edge
+// that the upright trapezoids on either side left out
+void* valleyThread(void* arg) {
+    TileArgs* args = (TileArgs*)arg;
+    int n = args->size;
+
+    for (int tile = args->workerId + 1; tile < args->tileCount; tile += args->workerCount) {
+        int edge = tile * args->tileWidth;
+
+        for (int t = 0; t < args->steps; t++) {
+            int from = edge - 1 - t;
+            int to = (edge + t - 1 < n - 2) ? edge + t - 1 : n - 2;
+            applyPhase(args->keys, args->firstStep + t, from, to);
+        }
+    }
+
+    return NULL;
+}
+
+// Odd-Even Transposition Sort with temporal blocking: the list is flattened into
+// an array and BLOCK_PHASES phases are applied to each cache-resident tile before
+// it is evicted, cutting memory traffic from O(n^2) to roughly O(n^2 / phases)
+void oddEvenSortBlocked(Node* root, int size, int blockPhases) {
+    printf("Starting Odd-Even Transposition Sort with Temporal Blocking...\n");
+
+    // Stable mode sorts packed (value, origin) words instead of plain values
+    void* keys = malloc(size * (stableMode ? sizeof(SortKey) : sizeof(int)));
+    Node* current = root;
+    for (int i = 0; i < size; i++) {
+        if (stableMode) {
+            ((SortKey*)keys)[i] = packKey(current->value, current->origin);
+        } else {
+            ((int*)keys)[i] = current->value;
+        }
+        current = current->right;
+    }
+
+    // Halo regions of neighbouring edges must not overlap
+    int tileWidth = TILE_WIDTH;
+    if (blockPhases > tileWidth / 2) {
+        blockPhases = tileWidth / 2;
+    }
+    if (blockPhases < 1) {
+        blockPhases = 1;
+    }
+
+    int tileCount = (size + tileWidth - 1) / tileWidth;
+    int workerCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (workerCount > tileCount) {
+        workerCount = tileCount;
+    }
+    if (workerCount < 1) {
+        workerCount = 1;
+    }
+
+    pthread_t* threads = (pthread_t*)malloc(workerCount * sizeof(pthread_t));
+    TileArgs* args = (TileArgs*)malloc(workerCount * sizeof(TileArgs));
+
+    int phase_count = 0;
+    while (size > 1 && phase_count < 2 * size) {
+        for (int i = 0; i < workerCount; i++) {
+            args[i].keys = keys;
+            args[i].size = size;
+            args[i].tileWidth = tileWidth;
+            args[i].tileCount = tileCount;
+            args[i].firstStep = phase_count;
+            args[i].steps = blockPhases;
+            args[i].workerId = i;
+            args[i].workerCount = workerCount;
+        }
+
+        runTileStage(trapezoidThread, args, threads, workerCount);
+        runTileStage(valleyThread, args, threads, workerCount);
+        phase_count += blockPhases;
+
+        // With verifyOnce, n phases always suffice and nothing is checked in between
+        bool lastBlock = verifyOnce && phase_count >= size;
+
+        // Write the block back whenever the network is printed or checked
+        if (!verifyOnce || lastBlock || size <= PRINT_LIMIT) {
+            current = root;
+            for (int i = 0; i < size; i++) {
+                if (stableMode) {
+                    SortKey key = ((SortKey*)keys)[i];
+                    current->value = unpackValue(key);
+                    current->origin = unpackOrigin(key);
+                } else {
+                    current->value = ((int*)keys)[i];
+                }
+                current = current->right;
+            }
+        }
+
+        if (size <= PRINT_LIMIT) {
+            printf("After phase %d: ", phase_count);
+            printNetwork(root);
+        }
+
+        if (lastBlock || (!verifyOnce && isSorted(root))) {
+            break;
+        }
+    }
+
+    printf("Sorting completed in %d phases.\n", phase_count);
+
+    free(threads);
+    free(args);
+    free(keys);
+}
+
+// Record a node that may now be out of order with a neighbour
+static void touchNode(Node* node, Node** touched, int* touchedCount) {
+    if (node != NULL) {
+        touched[(*touchedCount)++] = node;
+    }
+}
+
+// Apply a single update to the line, recording every node next to the change and
+// every node it removes
+static void applyUpdate(ResortState* state, Node** root, int* size, Update* update,
+                        Node** touched, int* touchedCount, Node** deleted, int* deletedCount) {
+    // A node removed earlier in the batch is no longer part of the line
+    if (update->node != NULL && update->node->deleted) return;
+
+    if (update->kind == UPDATE_SET) {
+        if (update->node == NULL) return;
+        Node* node = update->node;
+
+        node->value = update->value;
+        node->origin = state->nextOrigin++;
+        touchNode(node, touched, touchedCount);
+    }
+    else if (update->kind == UPDATE_INSERT) {
+        Node* node = (Node*)malloc(sizeof(Node));
+        node->value = update->value;
+        node->origin = state->nextOrigin++;
+        node->window = -1;
+        node->joinedAt = 0;
+        node->changedAt = 0;
+        node->deleted = false;
+        pthread_mutex_init(&node->lock, NULL);
+
+        // Splice in after the given node, or at the front; the index only has to
+        // alternate in parity with the left neighbour, so nothing is renumbered
+        Node* prev = update->node;
+        Node* next = (prev != NULL) ? prev->right : *root;
+        node->left = prev;
+        node->right = next;
+        if (prev != NULL) {
+            node->index = prev->index + 1;
+            prev->right = node;
+        } else {
+            node->index = (next != NULL) ? next->index - 1 : 0;
+            *root = node;
+        }
+        if (next != NULL) {
+            next->left = node;
+        }
+        touchNode(node, touched, touchedCount);
+        (*size)++;
+    }
+    else if (update->kind == UPDATE_DELETE) {
+        if (update->node == NULL) return;
+        Node* node = update->node;
+
+        // The neighbours become adjacent and may be out of order
+        if (node->left != NULL) {
+            node->left->right = node->right;
+        } else {
+            *root = node->right;
+        }
+        if (node->right != NULL) {
+            node->right->left = node->left;
+        }
+        touchNode(node->left, touched, touchedCount);
+        touchNode(node->right, touched, touchedCount);
+
+        // Keep the node until the batch is applied, so later updates can see it is gone
+        node->deleted = true;
+        deleted[(*deletedCount)++] = node;
+        (*size)--;
+    }
+}
+
+// Prepare the re-sort state of a freshly built network of the given size. New
+// values get origins past every existing one, so they rank after equal keys
+void initResortState(ResortState* state, int size) {
+    state->phaseCount = 0;
+    state->nextOrigin = size;
+}
+
+// Check whether the pair starting at a window node has stayed ordered and unchanged
+// through the last odd and even phase, so that the window no longer needs it
+static bool pairSettled(Node* node, int phase) {
+    return node->joinedAt <= phase - 2 && node->changedAt <= phase - 2 &&
+           (node->right == NULL || node->right->changedAt <= phase - 2);
+}
+
+// Incrementally re-sort a network that was sorted before the given updates.
+// Odd-even phases run only inside windows around the changed nodes. A window grows
+// while the pair just outside it is out of order and sheds its trailing pairs once
+// they have compared without a swap in an odd and an even phase, so each window
+// follows the keys that are still moving. Windows that meet simply abut: every pair
+// belongs to at most one window. Neither the updates nor the phases walk the line,
+// so the work follows the displacement of the changed keys rather than n.
+// Returns the number of phases run.
+int oddEvenResort(ResortState* state, Node** root, int* size, Update* updates, int count) {
+    // Phases are numbered across calls so that older change stamps never look recent
+    int start = state->phaseCount;
+
+    Node** touched = (Node**)malloc((2 * count + 1) * sizeof(Node*));
+    Node** deleted = (Node**)malloc((count + 1) * sizeof(Node*));
+    int touchedCount = 0;
+    int deletedCount = 0;
+    for (int i = 0; i < count; i++) {
+        applyUpdate(state, root, size, &updates[i], touched, &touchedCount, deleted, &deletedCount);
+    }
+
+    // Each changed node may be out of order with either neighbour, so its window
+    // starts with the pairs on both sides of it
+    Window* windows = (Window*)malloc((touchedCount + 1) * sizeof(Window));
+    int windowCount = 0;
+    for (int i = 0; i < touchedCount; i++) {
+        Node* node = touched[i];
+        if (node->deleted) continue;
+        node->changedAt = start;
+
+        if (node->window < 0) {
+            Node* left = node->left;
+            if (left != NULL && left->window >= 0 && windows[left->window].last == left) {
+                windows[left->window].last = node;
+                node->window = left->window;
+            } else {
+                windows[windowCount].first = node;
+                windows[windowCount].last = node;
+                node->window = windowCount++;
+            }
+            node->joinedAt = start;
+        }
+        if (node->left != NULL && node->left->window < 0 && windows[node->window].first == node) {
+            windows[node->window].first = node->left;
+            node->left->window = node->window;
+            node->left->joinedAt = start;
+        }
+    }
+    free(touched);
+
+    for (int i = 0; i < deletedCount; i++) {
+        pthread_mutex_destroy(&deleted[i]->lock);
+        free(deleted[i]);
+    }
+    free(deleted);
+
+    int alive = windowCount;
+    while (alive > 0) {
+        int phase = ++state->phaseCount;
+
+        for (int w = 0; w < windowCount; w++) {
+            Window* window = &windows[w];
+            if (window->first == NULL) continue;
+
+            for (Node* current = window->first; ; current = current->right) {
+                if ((current->index & 1) == (phase & 1) && current->right != NULL &&
+                    nodeGreater(current, current->right)) {
+                    swapNodeValues(current, current->right);
+                    current->changedAt = phase;
+                    current->right->changedAt = phase;
+                }
+                if (current == window->last) break;
+            }
+
+            // Grow the window while the free pair just outside it is out of order
+            Node* edge = window->first->left;
+            if (edge != NULL && edge->window < 0 && nodeGreater(edge, window->first)) {
+                window->first = edge;
+                edge->window = w;
+                edge->joinedAt = phase;
+            }
+            edge = window->last->right;
+            if (edge != NULL && edge->window < 0 && edge->right != NULL && nodeGreater(edge, edge->right)) {
+                window->last = edge;
+                edge->window = w;
+                edge->joinedAt = phase;
+            }
+
+            // Shed settled pairs from both ends; an empty window is done
+            while (window->first != NULL && pairSettled(window->first, phase)) {
+                window->first->window = -1;
+                if (window->first == window->last) {
+                    window->first = NULL;
+                    alive--;
+                } else {
+                    window->first = window->first->right;
+                }
+            }
+            while (window->first != NULL && pairSettled(window->last, phase)) {
+                window->last->window = -1;
+                if (window->first == window->last) {
+                    window->first = NULL;
+                    alive--;
+                } else {
+                    window->last = window->last->left;
+                }
+            }
+        }
+    }
+
+    free(windows);
+    return state->phaseCount - start;
+}
+
+// Odd-Even Transposition Sort under injected faults, simulated serially: a pair is
+// compared only when both processors are active and the message on the link
+// between them gets through. Runs the fault-free bound of n phases, or with
+// selfStabilise until every pair has been compared since the last swap.
+void oddEvenSortFaulty(Node* root, int size) {
+    printf("Starting Odd-Even Transposition Sort with Fault Injection...\n");
+
+    FaultState state;
+    initFaultState(&state, size);
+
+    int phase_count = 0;
+    int sortedAt = isSorted(root) ? 0 : -1;
+    int lastSwapPhase = 0;
+    int totalFaults = 0;
+
+    while (phase_count < FAULT_ROUND_LIMIT * size + STUCK_ROUNDS) {
+        if (!faults.selfStabilise && phase_count >= size) break;
+
+        drawFaults(&state, size, phase_count);
+        int parity = phase_count % 2;
+        int swaps = 0;
+        int skipped = 0;
+
+        // Positions are counted here, since a re-sorted network keeps no line order in index
+        int i = 0;
+        for (Node* current = root; current != NULL && current->right != NULL; current = current->right, i++) {
+            if (i % 2 != parity) continue;
+
+            if (!state.active[i] || !state.active[i + 1] || state.dropped[i]) {
+                skipped++;
+                continue;
+            }
+            if (nodeGreater(current, current->right)) {
+                swapNodeValues(current, current->right);
+                swaps++;
+            }
+            state.checkedAt[i] = phase_count + 1;
+        }
+
+        phase_count++;
+        totalFaults += state.faultCount;
+        if (sortedAt < 0 && isSorted(root)) {
+            sortedAt = phase_count;
+        }
+
+        if (size <= PRINT_LIMIT) {
+            printf("After phase %d (%d skipped): ", phase_count, skipped);
+            printNetwork(root);
+        }
+
+        if (swaps > 0) {
+            lastSwapPhase = phase_count;
+        }
+        if (faults.selfStabilise && quiescent(&state, size - 1, lastSwapPhase)) break;
+    }
+
+    reportFaultRun("phases", phase_count, sortedAt, size, totalFaults);
+
+    cleanupFaultState(&state);
+}
+
+// Compare the blocked engine in unstable and stable mode on the same
+// few-unique input, where tie-breaking on the origin matters most
+void benchmarkStableMode(int size, int blockPhases) {
+    // Few unique keys: heavy duplicates
+    generator.distribution = DIST_FEW_UNIQUE;
+    int* values = (int*)malloc(size * sizeof(int));
+    generateKeys(values, size);
+
+    double elapsed[2];
+    for (int mode = 0; mode <= 1; mode++) {
+        stableMode = (mode == 1);
+        Node* root = initNetworkWithValues(values, size);
+
+        double start = wallTime();
+        oddEvenSortBlocked(root, size, blockPhases);
+        elapsed[mode] = wallTime() - start;
+
+        if (!isSorted(root)) {
+            printf("ERROR: Network is not sorted correctly!\n");
+        }
+        cleanupNetwork(root);
+    }
+
+    printf("Unstable mode: %f seconds\n", elapsed[0]);
+    printf("Stable mode:   %f seconds (%.2fx)\n", elapsed[1], elapsed[1] / elapsed[0]);
+
+    stableMode = false;
+    free(values);
+}
+
 // Main function to test Odd-Even Transposition Sort
 int main(int argc, char* argv[]) {
     int size = 10;  // Default size
+    int blockPhases = 0;  // 0 selects the thread-per-node engine
+    int updateCount = 0;  // Random updates applied after the initial sort
+    bool benchStable = false;  // Benchmark stable against unstable mode
+    generator.seed = (uint64_t)time(NULL);  // Overridden by --seed
+
+    // Parse the size and optional flags from the command line
+    for (int i = 1; i < argc; i++) {
+        if (parseGeneratorFlag(argc, argv, &i) || parseFaultFlag(argc, argv, &i)) {
+            continue;
+        } else if (strcmp(argv[i], "--blocked") == 0 && i + 1 < argc && argv[i + 1][0] != '-') {
+            blockPhases = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--blocked") == 0) {
+            blockPhases = BLOCK_PHASES;
+        } else if (strcmp(argv[i], "--verify-once") == 0) {
+            verifyOnce = true;
+        } else if (strcmp(argv[i], "--stable") == 0) {
+            stableMode = true;
+        } else if (strcmp(argv[i], "--bench-stable") == 0) {
+            benchStable = true;
+        } else if (strcmp(argv[i], "--updates") == 0 && i + 1 < argc) {
+            updateCount = atoi(argv[++i]);
+        } else {
+            size = atoi(argv[i]);
+        }
+    }
+
+    // Updates in the demo derive from the same seed as the keys
+    srand((unsigned int)generator.seed);
+    printf("Seed: %llu\n", (unsigned long long)generator.seed);
 
-    // Check if size is provided as command line argument
-    if (argc > 1) {
-        size = atoi(argv[1]);
+    if (benchStable) {
+        benchmarkStableMode(size, (blockPhases > 0) ? blockPhases : BLOCK_PHASES);
+        return 0;
     }
 
     // Create a network
     Node* root = initNetwork(size);
+    ResortState resort;
+    initResortState(&resort, size);
 
     // Print the initial state
     printf("Initial state (n=%d):\n", size);
     printNetwork(root);
+    Verification before = verifyNetwork(root, size);
 
     // Execute Odd-Even Transposition Sort
     clock_t start = clock();
-    oddEvenSort(root, size);
+    if (faultModeEnabled()) {
+        oddEvenSortFaulty(root, size);
+    } else if (blockPhases > 0) {
+        oddEvenSortBlocked(root, size, blockPhases);
+    } else {
+        oddEvenSort(root, size);
+    }
     clock_t end = clock();
 
-    // Check if sorted correctly
-    if (isSorted(root)) {
+    // Check if sorted correctly and that no value was lost or duplicated
+    double verifyStart = wallTime();
+    Verification after = verifyNetwork(root, size);
+    double verifyTime = wallTime() - verifyStart;
+    if (after.sorted) {
         printf("Network is correctly sorted.\n");
     } else {
         printf("ERROR: Network is not sorted correctly!\n");
     }
+    if (!sameMultiset(&before, &after)) {
+        printf("ERROR: Checksum mismatch, values were lost or duplicated!\n");
+    }
 
     // Print execution time
     double cpu_time_used = ((double) (end - start)) / CLOCKS_PER_SEC;
     printf("Execution time: %f seconds\n", cpu_time_used);
+    printf("Verification time: %f seconds\n", verifyTime);
+
+    // Change a few keys of the sorted network and re-sort only what moved
+    if (updateCount > 0) {
+        // Pick one processor from each of updateCount equal strides, so that
+        // every update holds a distinct handle
+        if (updateCount > size) {
+            updateCount = size;
+        }
+        Update* updates = (Update*)malloc((updateCount + 1) * sizeof(Update));
+        int stride = (updateCount > 0) ? size / updateCount : 0;
+        Node* current = root;
+        int position = 0;
+        for (int i = 0; i < updateCount; i++) {
+            int target = i * stride + rand() % stride;
+            while (position < target) {
+                current = current->right;
+                position++;
+            }
+            updates[i].kind = (UpdateKind)(rand() % 3);
+            updates[i].node = current;
+            updates[i].value = rand() % 1000;
+        }
+
+        start = clock();
+        int phases = oddEvenResort(&resort, &root, &size, updates, updateCount);
+        end = clock();
+
+        printf("After %d updates (n=%d): ", updateCount, size);
+        printNetwork(root);
+        printf("Re-sorting completed in %d phases.\n", phases);
+        if (isSorted(root)) {
+            printf("Network is correctly sorted.\n");
+        } else {
+            printf("ERROR: Network is not sorted correctly!\n");
+        }
+        cpu_time_used = ((double) (end - start)) / CLOCKS_PER_SEC;
+        printf("Execution time: %f seconds\n", cpu_time_used);
+
+        free(updates);
+    }
 
     // Clean up
     cleanupNetwork(root);
@@ -3,10 +3,17 @@
 #include <time.h>
 #include <stdbool.h>
 #include <limits.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "line_network.h"
 
 // Structure to represent an element with its value and marking
 typedef struct {
     int value;          // Value stored in the element
+    int origin;         // Slot of the element before sorting (2 per node)
     bool isMarked;      // Whether the element is marked (true for original elements)
 } Element;
 
@@ -19,26 +26,32 @@ typedef struct Node {
     struct Node* right; // Pointer to right neighbor
 } Node;
 
-// Initialize the network with random values
+// Initialize the network with generated values
 Node* initNetwork(int size) {
-    // Seed the random number generator
-    srand(time(NULL));
+    // Generate a key for every slot (two per node) up front, in parallel and
+    // reproducibly from the seed
+    int* keys = (int*)malloc(2 * size * sizeof(int));
+    generateKeys(keys, 2 * size);
 
     Node* root = NULL;
     Node* prev = NULL;
 
-    // Create linked list of processors
+    // Create linked list of processors, stored contiguously so that verification
+    // workers can index them
+    Node* nodes = (Node*)malloc(size * sizeof(Node));
     for (int i = 0; i < size; i++) {
-        Node* node = (Node*)malloc(sizeof(Node));
+        Node* node = &nodes[i];
 
         if (i == 0) {
             // First node - set left value to INT_MIN (sentinel)
             Element* lElement = (Element*)malloc(sizeof(Element));
             lElement->value = INT_MIN;
+            lElement->origin = 0;
             lElement->isMarked = false;
 
             Element* rElement = (Element*)malloc(sizeof(Element));
-            rElement->value = rand() % 1000;  // Random value between 0 and 999
+            rElement->value = keys[2 * i + 1];
+            rElement->origin = 2 * i + 1;
             rElement->isMarked = true;
 
             node->lValue = lElement;
@@ -49,11 +62,13 @@ Node* initNetwork(int size) {
         else if (i == size - 1) {
             // Last node - set right value to INT_MAX (sentinel)
             Element* lElement = (Element*)malloc(sizeof(Element));
-            lElement->value = rand() % 1000;  // Random value between 0 and 999
+            lElement->value = keys[2 * i];
+            lElement->origin = 2 * i;
             lElement->isMarked = true;
 
             Element* rElement = (Element*)malloc(sizeof(Element));
             rElement->value = INT_MAX;
+            rElement->origin = -1;  // Ranks after any real INT_MAX
             rElement->isMarked = false;
 
             node->lValue = lElement;
@@ -63,11 +78,13 @@ Node* initNetwork(int size) {
         else {
             // Middle nodes
             Element* lElement = (Element*)malloc(sizeof(Element));
-            lElement->value = rand() % 1000;  // Random value between 0 and 999
+            lElement->value = keys[2 * i];
+            lElement->origin = 2 * i;
             lElement->isMarked = true;
 
             Element* rElement = (Element*)malloc(sizeof(Element));
-            rElement->value = rand() % 1000;  // Random value between 0 and 999
+            rElement->value = keys[2 * i + 1];
+            rElement->origin = 2 * i + 1;
             rElement->isMarked = true;
 
             node->lValue = lElement;
@@ -86,6 +103,7 @@ Node* initNetwork(int size) {
         prev = node;
     }
 
+    free(keys);
     return root;
 }
 
@@ -94,18 +112,22 @@ Node* initNetworkWithValues(int arr[], int size) {
     Node* root = NULL;
     Node* prev = NULL;
 
-    // Create linked list of processors
+    // Create linked list of processors, stored contiguously so that verification
+    // workers can index them
+    Node* nodes = (Node*)malloc(size * sizeof(Node));
     for (int i = 0; i < size; i++) {
-        Node* node = (Node*)malloc(sizeof(Node));
+        Node* node = &nodes[i];
 
         if (i == 0) {
             // First node - set left value to INT_MIN (sentinel)
             Element* lElement = (Element*)malloc(sizeof(Element));
             lElement->value = INT_MIN;
+            lElement->origin = 0;
             lElement->isMarked = false;
 
             Element* rElement = (Element*)malloc(sizeof(Element));
             rElement->value = arr[i];
+            rElement->origin = 2 * i + 1;
             rElement->isMarked = true;
 
             node->lValue = lElement;
@@ -117,10 +139,12 @@ Node* initNetworkWithValues(int arr[], int size) {
             // Last node - set right value to INT_MAX (sentinel)
             Element* lElement = (Element*)malloc(sizeof(Element));
             lElement->value = arr[i-1];
+            lElement->origin = 2 * i;
             lElement->isMarked = true;
 
             Element* rElement = (Element*)malloc(sizeof(Element));
             rElement->value = INT_MAX;
+            rElement->origin = -1;  // Ranks after any real INT_MAX
             rElement->isMarked = false;
 
             node->lValue = lElement;
@@ -131,10 +155,12 @@ Node* initNetworkWithValues(int arr[], int size) {
             // Middle nodes
             Element* lElement = (Element*)malloc(sizeof(Element));
             lElement->value = arr[i-1];
+            lElement->origin = 2 * i;
             lElement->isMarked = true;
 
             Element* rElement = (Element*)malloc(sizeof(Element));
             rElement->value = arr[i];
+            rElement->origin = 2 * i + 1;
             rElement->isMarked = true;
 
             node->lValue = lElement;
@@ -156,6 +182,14 @@ Node* initNetworkWithValues(int arr[], int size) {
     return root;
 }
 
+// Check whether element a must be placed after element b
+static bool elementGreater(Element* a, Element* b) {
+    if (stableMode) {
+        return packKey(a->value, a->origin) > packKey(b->value, b->origin);
+    }
+    return a->value > b->value;
+}
+
 // Print the network (for debugging)
 void printNetworkDebug(Node* root) {
     Node* temp = root;
@@ -187,22 +221,22 @@ void printNetwork(Node* root) {
 
 // Check if the network is sorted
 int isSorted(Node* root) {
-    int prev_value = INT_MIN;
+    Element* prev = NULL;
     Node* temp = root;
 
     while (temp != NULL) {
-        int current_value;
+        Element* current;
         if (temp->area == -1) {
-            current_value = temp->rValue->value;
+            current = temp->rValue;
         } else {
-            current_value = temp->lValue->value;
+            current = temp->lValue;
         }
 
-        if (current_value != INT_MAX && current_value != INT_MIN) {
-            if (current_value < prev_value) {
+        if (current->value != INT_MAX && current->value != INT_MIN) {
+            if (prev != NULL && elementGreater(prev, current)) {
                 return 0;  // Not sorted
             }
-            prev_value = current_value;
+            prev = current;
         }
 
         temp = temp->right;
@@ -211,11 +245,67 @@ int isSorted(Node* root) {
     return 1;  // Sorted
 }
 
-// Compare and potentially swap elements in a node
-void compareAndSwap(Node* node) {
+// Find the key a node shows in display order (area rule); false for a sentinel
+static bool displayKey(const Node* node, SortKey* key) {
+    Element* current = (node->area == -1) ? node->rValue : node->lValue;
+    if (current->value == INT_MAX || current->value == INT_MIN) {
+        return false;
+    }
+    *key = packKey(current->value, stableMode ? current->origin : 0);
+    return true;
+}
+
+// Thread function to verify one chunk of nodes in place: the keys shown in display
+// order must be sorted up to the next key shown past the chunk, and both slots of
+// every node are folded into the checksum
+void* verifyNodeChunk(void* arg) {
+    VerifyArgs* args = (VerifyArgs*)arg;
+    const Node* nodes = (const Node*)args->source;
+    bool seen = false;
+    SortKey previous = 0;
+    SortKey key;
+
+    for (int i = args->from; i < args->to; i++) {
+        if (displayKey(&nodes[i], &key)) {
+            if (seen && previous > key) {
+                args->result.sorted = false;
+            }
+            previous = key;
+            seen = true;
+        }
+        addToChecksum(&args->result, packKey(nodes[i].lValue->value, 0));
+        addToChecksum(&args->result, packKey(nodes[i].rValue->value, 0));
+    }
+
+    // Sentinels only sit at the ends, so this scan stops after a node or two
+    for (int i = args->to; seen && i < args->size; i++) {
+        if (displayKey(&nodes[i], &key)) {
+            if (previous > key) {
+                args->result.sorted = false;
+            }
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+// Verify the network in parallel: the values in display order (area rule, without
+// sentinels) must be sorted, and the elements across all slots, two per node, must
+// form the same multiset as before, which catches Element pointers lost or
+// duplicated by a swap. Nodes are contiguous, so each worker reads its own range
+Verification verifyNetwork(Node* root, int size) {
+    return verifyParallel(verifyNodeChunk, root, size);
+}
+
+// Compare and potentially swap elements of a node over the links that are up,
+// returning the number of swaps
+int exchangeElements(Node* node, bool leftLink, bool rightLink) {
+    int swaps = 0;
+
     // First, check left neighbor connection if exists
-    if (node->left != NULL) {
-        if (node->left->rValue->value > node->lValue->value) {
+    if (node->left != NULL && leftLink) {
+        if (elementGreater(node->left->rValue, node->lValue)) {
             // Update areas if marked elements are moving
             if (node->left->rValue->isMarked) {
                 node->area--;
@@ -228,12 +318,13 @@ void compareAndSwap(Node* node) {
             Element* temp = node->left->rValue;
             node->left->rValue = node->lValue;
             node->lValue = temp;
+            swaps++;
         }
     }
 
     // Then, check right neighbor connection if exists
-    if (node->right != NULL) {
-        if (node->right->lValue->value < node->rValue->value) {
+    if (node->right != NULL && rightLink) {
+        if (elementGreater(node->rValue, node->right->lValue)) {
             // Update areas if marked elements are moving
             if (node->right->lValue->isMarked) {
                 node->right->area++;
@@ -246,16 +337,25 @@ void compareAndSwap(Node* node) {
             Element* temp = node->right->lValue;
             node->right->lValue = node->rValue;
             node->rValue = temp;
+            swaps++;
         }
     }
 
     // Finally, compare left and right values within the node
-    if (node->lValue->value > node->rValue->value) {
+    if (elementGreater(node->lValue, node->rValue)) {
         // Swap values
         Element* temp = node->lValue;
         node->lValue = node->rValue;
         node->rValue = temp;
+        swaps++;
     }
+
+    return swaps;
+}
+
+// Compare and potentially swap elements in a node
+void compareAndSwap(Node* node) {
+    exchangeElements(node, true, true);
 }
 
 // Clean up the network resources
@@ -269,11 +369,11 @@ void cleanupNetwork(Node* root) {
         free(current->lValue);
         free(current->rValue);
 
-        // Free node
-        free(current);
-
         current = next;
     }
+
+    // Free the nodes, allocated as one array
+    free(root);
 }
 
 // Sasaki's Time-Optimal Sorting Algorithm
@@ -302,33 +402,115 @@ void sasakiSort(Node* root, int size) {
     printf("Sorting completed.\n");
 }
 
+// Sasaki's algorithm under injected faults: a processor only works when it is
+// active, and only exchanges with a neighbour that is active and whose message
+// gets through. Runs the fault-free bound of n-1 rounds, or with selfStabilise
+// until every processor has compared its slots and its right link since the last
+// swap, which leaves every slot in order.
+void sasakiSortFaulty(Node* root, int size) {
+    printf("Starting Sasaki's Time-Optimal Sorting Algorithm with Fault Injection...\n");
+
+    printf("Initial state: ");
+    printNetwork(root);
+
+    FaultState state;
+    initFaultState(&state, size);
+
+    int round = 0;
+    int sortedAt = isSorted(root) ? 0 : -1;
+    int lastSwapRound = 0;
+    int totalFaults = 0;
+
+    while (round < FAULT_ROUND_LIMIT * size + STUCK_ROUNDS) {
+        if (!faults.selfStabilise && round >= size - 1) break;
+        round++;
+
+        drawFaults(&state, size, round);
+        int swaps = 0;
+        int skipped = 0;
+
+        int i = 0;
+        for (Node* current = root; current != NULL; current = current->right, i++) {
+            bool leftLink = i > 0 && state.active[i] && state.active[i - 1] && !state.dropped[i - 1];
+            bool rightLink = i < size - 1 && state.active[i] && state.active[i + 1] && !state.dropped[i];
+            skipped += (i > 0 && !leftLink) + (i < size - 1 && !rightLink);
+
+            if (state.active[i]) {
+                swaps += exchangeElements(current, leftLink, rightLink);
+                if (i == size - 1 || rightLink) {
+                    state.checkedAt[i] = round;
+                }
+            }
+        }
+
+        totalFaults += state.faultCount;
+        if (sortedAt < 0 && isSorted(root)) {
+            sortedAt = round;
+        }
+
+        printf("Round %d (%d skipped): ", round, skipped);
+        printNetwork(root);
+
+        if (swaps > 0) {
+            lastSwapRound = round;
+        }
+        if (faults.selfStabilise && quiescent(&state, size, lastSwapRound)) break;
+    }
+
+    reportFaultRun("rounds", round, sortedAt, (size > 1) ? size - 1 : 0, totalFaults);
+
+    cleanupFaultState(&state);
+}
+
 // Main function to test Sasaki's Time-Optimal Sort
 int main(int argc, char* argv[]) {
     int size = 10;  // Default size
 
-    // Check if size is provided as command line argument
-    if (argc > 1) {
-        size = atoi(argv[1]);
+    generator.seed = (uint64_t)time(NULL);  // Overridden by --seed
+
+    // Parse the size and optional flags from the command line
+    for (int i = 1; i < argc; i++) {
+        if (parseGeneratorFlag(argc, argv, &i) || parseFaultFlag(argc, argv, &i)) {
+            continue;
+        } else if (strcmp(argv[i], "--stable") == 0) {
+            stableMode = true;
+        } else {
+            size = atoi(argv[i]);
+        }
     }
 
+    printf("Seed: %llu\n", (unsigned long long)generator.seed);
+
     // Create a network
     Node* root = initNetwork(size);
+    Verification before = verifyNetwork(root, size);
 
     // Execute Sasaki's algorithm
     clock_t start = clock();
-    sasakiSort(root, size);
+    if (faultModeEnabled()) {
+        sasakiSortFaulty(root, size);
+    } else {
+        sasakiSort(root, size);
+    }
     clock_t end = clock();
 
-    // Check if sorted correctly
-    if (isSorted(root)) {
+    // Check if sorted correctly and that no element was lost or duplicated
+    double verifyStart = wallTime();
+    Verification after = verifyNetwork(root, size);
+    double verifyTime = wallTime() - verifyStart;
+    if (after.sorted) {
         printf("Network is correctly sorted.\n");
     } else {
         printf("ERROR: Network is not sorted correctly!\n");
     }
+    if (!sameMultiset(&before, &after)) {
+        printf("ERROR: Checksum mismatch, elements were lost or duplicated!\n");
+    }
 
     // Print execution time
     double cpu_time_used = ((double) (end - start)) / CLOCKS_PER_SEC;
     printf("Execution time: %f seconds\n", cpu_time_used);
+    printf("Verification time: %f seconds\n", verifyTime);
 
     // Clean up
     cleanupNetwork(root);